@@ -1,6 +1,15 @@
 #!/bin/sh
-# Simple build script for running distance tests
+# Simple build script for running the unit tests.
+# Pass "bench" to also build and run the microbenchmarks.
 set -e
 mkdir -p build_tests
 cc -IInclude tests/test_distance.c -o build_tests/test_distance
 build_tests/test_distance
+cc -IInclude tests/test_fixmath.c -o build_tests/test_fixmath
+build_tests/test_fixmath
+if [ "$1" = "bench" ]; then
+    cc -O2 -IInclude tests/bench_fixmath.c -o build_tests/bench_fixmath
+    build_tests/bench_fixmath
+    cc -O2 -IInclude tests/bench_floortile.c -o build_tests/bench_floortile -lm
+    build_tests/bench_floortile
+fi
@@ -0,0 +1,76 @@
+#include <stdio.h>
+#include <time.h>
+#include "../Include/FIXMATH.H"
+
+/* Microbenchmark of FIXMATH.H against the double precision fallbacks */
+/* it replaced.  Build with optimization on, e.g.: */
+/*     cc -O2 -IInclude tests/bench_fixmath.c -o build_tests/bench_fixmath */
+
+#define LegacyMultAndShift16(a, b)  ((T_sword32)((((double)(a)) * ((double)(b))) / 65536.0))
+#define LegacyMultAndShift32(a, b)  ((T_sword32)(((((double)(a)) * ((double)(b))) / 65536.0) / 65536.0))
+#define LegacyDiv32by32To1616(a, b) ((T_sword32)((((double)(a)) * 65536.0) / ((double)(b))))
+#define LegacyMult32By32AndDiv32(a, b, c) \
+            ((T_sword32)((((double)(a)) * ((double)(b))) / ((double)(c))))
+
+#define NUM_VALUES      4096
+#define NUM_PASSES      4000
+
+static T_sword32 G_a[NUM_VALUES] ;
+static T_sword32 G_b[NUM_VALUES] ;
+static T_sword32 G_c[NUM_VALUES] ;
+static volatile T_sword32 G_sink ;
+
+static double ISeconds(clock_t start)
+{
+    return ((double)(clock() - start)) / CLOCKS_PER_SEC ;
+}
+
+/* Each result feeds the next input, as in the dependent arithmetic of */
+/* a wall or span setup, so the loop measures latency and the compiler */
+/* cannot vectorize it. */
+#define A       (G_a[i] ^ (sum & 1))
+#define B       (G_b[i] ^ (sum & 1))
+
+#define BENCH(name, expr)                                                  \
+    {                                                                      \
+        clock_t start = clock() ;                                          \
+        T_sword32 sum = 0 ;                                                \
+        T_word32 pass, i ;                                                 \
+        for (pass=0; pass<NUM_PASSES; pass++)                              \
+            for (i=0; i<NUM_VALUES; i++)                                   \
+                sum = (expr) ;                                             \
+        G_sink = sum ;                                                     \
+        printf("%-28s %6.2f ns/op\n", name,                                \
+               ISeconds(start) * 1e9 / ((double)NUM_PASSES * NUM_VALUES)) ; \
+    }
+
+int main(void)
+{
+    T_word32 i ;
+    T_word32 seed = 1 ;
+
+    /* Values in the range the renderer sees: 16.16 coordinates and */
+    /* inverse distances, never a zero divider. */
+    for (i=0; i<NUM_VALUES; i++)  {
+        seed = seed * 1103515245 + 12345 ;
+        G_a[i] = ((T_sword32)seed) >> 8 ;
+        seed = seed * 1103515245 + 12345 ;
+        G_b[i] = ((T_sword32)seed) >> 12 ;
+        seed = seed * 1103515245 + 12345 ;
+        G_c[i] = (T_sword32)((seed >> 12) | 1) ;
+    }
+
+    BENCH("legacy MultAndShift16", LegacyMultAndShift16(A, G_b[i])) ;
+    BENCH("MultAndShift16", MultAndShift16(A, G_b[i])) ;
+    BENCH("legacy MultAndShift32", LegacyMultAndShift32(A, G_b[i])) ;
+    BENCH("MultAndShift32", MultAndShift32(A, G_b[i])) ;
+    BENCH("legacy Div32by32To1616", LegacyDiv32by32To1616(B, G_c[i])) ;
+    BENCH("Div32by32To1616Asm", Div32by32To1616Asm(B, G_c[i])) ;
+    BENCH("legacy Mult32By32AndDiv32",
+          LegacyMult32By32AndDiv32(A, G_b[i], G_c[i])) ;
+    BENCH("Mult32By32AndDiv32", Mult32By32AndDiv32(A, G_b[i], G_c[i])) ;
+    BENCH("Mult32x32AndCompare",
+          Mult32x32AndCompare(A, G_b[i], G_b[i], G_c[i])) ;
+
+    return 0;
+}
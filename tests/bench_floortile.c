@@ -0,0 +1,228 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../Include/3D_TILE.H"
+
+/* Microbenchmark of the tiled floor row drawer in 3D_VIEW.C against */
+/* the plain run layout it replaced, over the floor and ceiling runs of */
+/* a moving camera.  It times the row drawers only, not whole frames. */
+/* Build with optimization on, e.g.: */
+/*     cc -O2 -IInclude tests/bench_floortile.c -o build_tests/bench_floortile -lm */
+
+#define SCREEN_WIDTH    320
+#define SCREEN_HEIGHT   200
+#define HALF_HEIGHT     (SCREEN_HEIGHT/2)
+#define NUM_TEXTURES    16
+#define NUM_SECTORS     NUM_TEXTURES
+#define SECTOR_WIDTH    80
+#define NUM_FRAMES      1000
+
+static T_byte8 G_shade[256] ;
+static T_byte8 G_screen[SCREEN_WIDTH * SCREEN_HEIGHT] ;
+static T_byte8 G_tiledScreen[SCREEN_WIDTH * SCREEN_HEIGHT] ;
+static T_byte8 *G_plain[NUM_TEXTURES] ;
+static T_byte8 *G_tiled[NUM_TEXTURES] ;
+
+/* Same globals the renderer's row drawers use. */
+static T_byte8 *G_CurrentTexturePos ;
+static T_word32 G_textureAndX, G_textureAndY ;
+static T_sword32 G_textureStepX, G_textureStepY ;
+
+static double ISeconds(clock_t start)
+{
+    return ((double)(clock() - start)) / CLOCKS_PER_SEC ;
+}
+
+/* Copy of the C DrawTextureRowAsm64 and friends. */
+static T_void IDrawPlainRow(
+                  T_byte8 *p_shade,
+                  T_word32 count,
+                  T_sword32 xOffset,
+                  T_sword32 yOffset,
+                  T_byte8 *p_pixel,
+                  T_word16 shiftY)
+{
+    while (count--)  {
+        *(p_pixel++) = p_shade[G_CurrentTexturePos[
+            (((xOffset >> 16) & G_textureAndX) << shiftY) |
+            ((yOffset >> 16) & G_textureAndY)]] ;
+        xOffset += G_textureStepX ;
+        yOffset += G_textureStepY ;
+    }
+}
+
+/* Copy of IDrawTiledRow. */
+static T_void IDrawTiledRow(
+                  T_byte8 *p_shade,
+                  T_word32 count,
+                  T_sword32 xOffset,
+                  T_sword32 yOffset,
+                  T_byte8 *p_pixel,
+                  T_word16 shiftY)
+{
+    T_word32 x, y ;
+    T_word32 stepX, stepY ;
+    T_word32 gapX, gapY ;
+    T_word32 mask ;
+    T_byte8 *p_texture ;
+
+    x = (T_word32)xOffset ;
+    y = (T_word32)yOffset ;
+    x = (TileSpreadU((x >> 16) & G_textureAndX, shiftY) << 16) | (x & 0xFFFF) ;
+    y = (TileSpreadV((y >> 16) & G_textureAndY) << 16) | (y & 0xFFFF) ;
+    stepX = (T_word32)G_textureStepX ;
+    stepY = (T_word32)G_textureStepY ;
+    stepX = (TileSpreadU((stepX >> 16) & G_textureAndX, shiftY) << 16) |
+            (stepX & 0xFFFF) ;
+    stepY = (TileSpreadV((stepY >> 16) & G_textureAndY) << 16) |
+            (stepY & 0xFFFF) ;
+    gapX = ~((TileSpreadU(G_textureAndX, shiftY) << 16) | 0xFFFF) ;
+    gapY = ~((TileSpreadV(G_textureAndY) << 16) | 0xFFFF) ;
+    x |= gapX ;
+    y |= gapY ;
+    mask = (G_textureAndX << shiftY) | G_textureAndY ;
+    p_texture = G_CurrentTexturePos ;
+
+    while (count--)  {
+        *(p_pixel++) = p_shade[p_texture[((x & y) >> 16) & mask]] ;
+        x = (x + stepX) | gapX ;
+        y = (y + stepY) | gapY ;
+    }
+}
+
+/* Draws the floors and ceilings of a frame the way IDrawFloorRun does, */
+/* seen from a camera that walks and turns through a room.  Each row is */
+/* cut into runs at sector edges, and each run works out its own start */
+/* and step from its sector's height and draws with its sector's */
+/* texture.  Only the run setup and the row drawers are copied here; */
+/* the rest of the renderer (walls, objects, the BSP walk) is not. */
+static T_void IDrawFrame(
+                  T_word32 frame,
+                  T_word16 shiftY,
+                  E_Boolean isTiled,
+                  T_byte8 *p_screen)
+{
+    T_word16 row ;
+    T_word16 start, end ;
+    T_word16 sector ;
+    double angle = frame * 0.013 ;
+    double px = 512.0 * sin(frame * 0.004) ;
+    double py = 512.0 * cos(frame * 0.003) ;
+    double height ;
+    double distance ;
+    double leftX, leftY, rightX, rightY ;
+    double stepX, stepY ;
+    T_sword32 x, y ;
+
+    G_textureAndX = G_textureAndY = (1 << shiftY) - 1 ;
+    for (row=0; row<SCREEN_HEIGHT; row++)  {
+        if (row == HALF_HEIGHT)
+            continue ;
+        end = (frame*3 + row) % SECTOR_WIDTH ;
+        for (start=0; start<SCREEN_WIDTH; start=end)  {
+            end += SECTOR_WIDTH ;
+            if (end > SCREEN_WIDTH)
+                end = SCREEN_WIDTH ;
+            sector = (start/SECTOR_WIDTH + row/16 + frame/50) % NUM_SECTORS ;
+
+            /* Eye height above the floor, or below the ceiling. */
+            if (row > HALF_HEIGHT)
+                height = 40.0 + 8.0 * (sector % 3) ;
+            else
+                height = 56.0 - 8.0 * (sector % 2) ;
+            distance = height * 160.0 /
+                           ((row > HALF_HEIGHT) ? (row - HALF_HEIGHT) :
+                                                  (HALF_HEIGHT - row)) ;
+
+            leftX = px + distance * cos(angle + 0.785) ;
+            leftY = py + distance * sin(angle + 0.785) ;
+            rightX = px + distance * cos(angle - 0.785) ;
+            rightY = py + distance * sin(angle - 0.785) ;
+            stepX = (rightX - leftX) / SCREEN_WIDTH ;
+            stepY = (rightY - leftY) / SCREEN_WIDTH ;
+            x = (T_sword32)((leftX + stepX * start) * 65536.0) ;
+            y = (T_sword32)((leftY + stepY * start) * 65536.0) ;
+            G_textureStepX = (T_sword32)(stepX * 65536.0) ;
+            G_textureStepY = (T_sword32)(stepY * 65536.0) ;
+
+            if (isTiled)  {
+                G_CurrentTexturePos = G_tiled[sector] ;
+                IDrawTiledRow(G_shade, end - start, x, y,
+                              p_screen + row*SCREEN_WIDTH + start, shiftY) ;
+            } else {
+                G_CurrentTexturePos = G_plain[sector] ;
+                IDrawPlainRow(G_shade, end - start, x, y,
+                              p_screen + row*SCREEN_WIDTH + start, shiftY) ;
+            }
+        }
+    }
+}
+
+static T_void IBench(T_word16 shiftY)
+{
+    T_word32 size = 1 << shiftY ;
+    T_word32 i, u, v ;
+    T_word32 frame ;
+    T_word32 seed = 1 ;
+    T_byte8 c ;
+    clock_t start ;
+    double plain, tiled ;
+    double pixels = ((double)NUM_FRAMES) * SCREEN_WIDTH * (SCREEN_HEIGHT-1) ;
+
+    for (i=0; i<NUM_TEXTURES; i++)  {
+        G_plain[i] = malloc(size * size) ;
+        G_tiled[i] = malloc(size * size) ;
+        for (u=0; u<size; u++)  {
+            for (v=0; v<size; v++)  {
+                seed = seed * 1103515245 + 12345 ;
+                c = (T_byte8)(seed >> 16) ;
+                G_plain[i][(u << shiftY) | v] = c ;
+                G_tiled[i][TileOffset(u, v, shiftY)] = c ;
+            }
+        }
+    }
+
+    /* Both layouts must draw exactly the same picture. */
+    for (frame=0; frame<NUM_FRAMES; frame+=37)  {
+        IDrawFrame(frame, shiftY, FALSE, G_screen) ;
+        IDrawFrame(frame, shiftY, TRUE, G_tiledScreen) ;
+        if (memcmp(G_screen, G_tiledScreen, sizeof(G_screen)) != 0)  {
+            printf("%dx%d: tiled floor does not match!\n", size, size) ;
+            exit(1) ;
+        }
+    }
+
+    start = clock() ;
+    for (frame=0; frame<NUM_FRAMES; frame++)
+        IDrawFrame(frame, shiftY, FALSE, G_screen) ;
+    plain = ISeconds(start) ;
+
+    start = clock() ;
+    for (frame=0; frame<NUM_FRAMES; frame++)
+        IDrawFrame(frame, shiftY, TRUE, G_tiledScreen) ;
+    tiled = ISeconds(start) ;
+
+    printf("%3dx%-3d plain %5.2f ns/pixel  tiled %5.2f ns/pixel\n",
+           size, size, plain * 1e9 / pixels, tiled * 1e9 / pixels) ;
+
+    for (i=0; i<NUM_TEXTURES; i++)  {
+        free(G_plain[i]) ;
+        free(G_tiled[i]) ;
+    }
+}
+
+int main(void)
+{
+    T_word16 i ;
+
+    for (i=0; i<256; i++)
+        G_shade[i] = (T_byte8)(i ^ 0x55) ;
+
+    IBench(6) ;
+    IBench(7) ;
+    IBench(8) ;
+
+    return 0;
+}
@@ -0,0 +1,184 @@
+#include <assert.h>
+#include <stdio.h>
+#include "../Include/FIXMATH.H"
+
+/* The double precision fallbacks the Windows build used before */
+/* FIXMATH.H.  Only valid while the result fits in 32 bits. */
+#define LegacyMultAndShift32(a, b)  ((T_sword32)(((((double)(a)) * ((double)(b))) / 65536.0) / 65536.0))
+#define LegacyMultAndShift22(a, b)  ((T_sword32)((((double)(a)) * ((double)(b))) / 4194304.0))
+#define LegacyMultAndShift16(a, b)  ((T_sword32)((((double)(a)) * ((double)(b))) / 65536.0))
+#define LegacyMultAndShift6(a, b)   ((T_sword32)((((double)(a)) * ((double)(b))) / 64.0))
+#define LegacyMultAndShift4(a, b)   ((T_sword32)((((double)(a)) * ((double)(b))) / 16.0))
+#define LegacyDiv32by32To1616(a, b) ((T_sword32)((((double)(a)) * 65536.0) / ((double)(b))))
+#define LegacyMult32By32AndDiv32(a, b, c) \
+            ((T_sword32)((((double)(a)) * ((double)(b))) / ((double)(c))))
+
+#define INT32_LOW   (-((T_sword64)0x7FFFFFFF) - 1)
+#define INT32_HIGH  ((T_sword64)0x7FFFFFFF)
+#define DOUBLE_EXACT (((T_sword64)1) << 53)
+
+static const T_sword32 G_edges[] = {
+    0, 1, -1, 2, -2, 15, -15, 16, -16, 17, -17, 63, -63, 64, -64,
+    0x7FFF, -0x7FFF, 0x8000, -0x8000, 0xFFFF, -0xFFFF,
+    0x10000, -0x10000, 0x10001, -0x10001, 0x3FFFFF, -0x3FFFFF,
+    0x400000, -0x400000, 0x12345678, -0x12345678,
+    0x7FFFFFFF, -0x7FFFFFFF, (T_sword32)0x80000000
+} ;
+#define NUM_EDGES (sizeof(G_edges) / sizeof(G_edges[0]))
+
+static T_word32 G_seed = 12345 ;
+
+static T_sword32 IRandomValue(T_void)
+{
+    G_seed = G_seed * 1103515245 + 12345 ;
+
+    /* Mix magnitudes so small and large values both show up. */
+    return ((T_sword32)G_seed) >> (G_seed & 31) ;
+}
+
+static T_sword64 IAbs64(T_sword64 value)
+{
+    return (value < 0) ? -value : value ;
+}
+
+static E_Boolean IFits32(T_sword64 value)
+{
+    return ((value >= INT32_LOW) && (value <= INT32_HIGH)) ? TRUE : FALSE ;
+}
+
+static T_void ICheckShifts(T_sword32 a, T_sword32 b)
+{
+    T_sword64 product = ((T_sword64)a) * b ;
+    T_sword64 exact ;
+    E_Boolean legacyValid = (IAbs64(product) <= DOUBLE_EXACT) ? TRUE : FALSE ;
+
+    exact = product / 16 ;
+    assert(MultAndShift4(a, b) == (T_sword32)exact) ;
+    if (legacyValid && IFits32(exact))
+        assert(MultAndShift4(a, b) == LegacyMultAndShift4(a, b)) ;
+
+    exact = product / 64 ;
+    assert(MultAndShift6(a, b) == (T_sword32)exact) ;
+    if (legacyValid && IFits32(exact))
+        assert(MultAndShift6(a, b) == LegacyMultAndShift6(a, b)) ;
+
+    exact = product / 65536 ;
+    assert(MultAndShift16(a, b) == (T_sword32)exact) ;
+    if (legacyValid && IFits32(exact))
+        assert(MultAndShift16(a, b) == LegacyMultAndShift16(a, b)) ;
+
+    exact = product / 4194304 ;
+    assert(MultAndShift22(a, b) == (T_sword32)exact) ;
+    if (legacyValid && IFits32(exact))
+        assert(MultAndShift22(a, b) == LegacyMultAndShift22(a, b)) ;
+
+    exact = product / (((T_sword64)1) << 32) ;
+    assert(MultAndShift32(a, b) == (T_sword32)exact) ;
+    if (legacyValid && IFits32(exact))
+        assert(MultAndShift32(a, b) == LegacyMultAndShift32(a, b)) ;
+
+    exact = (((T_sword64)a) * 65536) ;
+    if (b == 0)  {
+        assert(Div32by32To1616Asm(a, b) == FIXMATH_DIVIDE_BY_ZERO) ;
+    } else {
+        exact /= b ;
+        assert(Div32by32To1616Asm(a, b) == (T_sword32)exact) ;
+        if (IFits32(exact))
+            assert(Div32by32To1616Asm(a, b) == LegacyDiv32by32To1616(a, b)) ;
+    }
+}
+
+static T_void ICheckMultDiv(T_sword32 a, T_sword32 b, T_sword32 c)
+{
+    T_sword64 product = ((T_sword64)a) * b ;
+    T_sword64 exact ;
+
+    if (c == 0)  {
+        assert(Mult32By32AndDiv32(a, b, c) == FIXMATH_DIVIDE_BY_ZERO) ;
+        return ;
+    }
+
+    exact = product / c ;
+    assert(Mult32By32AndDiv32(a, b, c) == (T_sword32)exact) ;
+    assert(MultAndDivideAsm(a, b, c) == (T_sword32)exact) ;
+    if ((IAbs64(product) <= DOUBLE_EXACT) && IFits32(exact))
+        assert(Mult32By32AndDiv32(a, b, c) ==
+               LegacyMult32By32AndDiv32(a, b, c)) ;
+}
+
+static T_void ICheckCompare(T_sword32 a, T_sword32 b, T_sword32 c, T_sword32 d)
+{
+    T_sword64 ab = ((T_sword64)a) * b ;
+    T_sword64 cd = ((T_sword64)c) * d ;
+    T_sword32 result = Mult32x32AndCompare(a, b, c, d) ;
+
+    if (cd > ab)
+        assert(result == 1) ;
+    else if (cd < ab)
+        assert(result == -1) ;
+    else
+        assert(result == 0) ;
+}
+
+int main(void)
+{
+    T_word32 i, j, k ;
+    T_sword32 a, b, c, d ;
+
+    /* Rounding is toward zero, like the old double fallbacks. */
+    assert(MultAndShift16(-1, 1) == 0) ;
+    assert(MultAndShift16(-0x10000, 3) == -3) ;
+    assert(MultAndShift16(-0x18000, 1) == -1) ;
+    assert(MultAndShift4(-17, 1) == -1) ;
+    assert(MultAndShift32(-1, 1) == 0) ;
+    assert(Div32by32To1616Asm(1, 3) == 0x5555) ;
+    assert(Div32by32To1616Asm(-1, 3) == -0x5555) ;
+    assert(Mult32By32AndDiv32(-7, 1, 2) == -3) ;
+
+    /* 64 bit intermediates do not overflow. */
+    assert(MultAndShift32(0x7FFFFFFF, 0x7FFFFFFF) == 0x3FFFFFFF) ;
+    assert(MultAndShift32((T_sword32)0x80000000, (T_sword32)0x80000000) == 0x40000000) ;
+    assert(Mult32By32AndDiv32(0x40000000, 0x40000000, 0x40000000) == 0x40000000) ;
+    assert(Mult32By32AndDiv32((T_sword32)0x80000000, (T_sword32)0x80000000,
+                              (T_sword32)0x80000000) == (T_sword32)0x80000000) ;
+
+    /* Results too big for 32 bits keep their low 32 bits. */
+    assert(MultAndShift16(0x7FFFFFFF, 0x7FFFFFFF) == (T_sword32)0xFFFF0000) ;
+    assert(Div32by32To1616Asm(0x10000, 1) == 0) ;
+
+    /* Divide by zero does not fault. */
+    assert(Div32by32To1616Asm(5, 0) == FIXMATH_DIVIDE_BY_ZERO) ;
+    assert(Mult32By32AndDiv32(5, 5, 0) == FIXMATH_DIVIDE_BY_ZERO) ;
+
+    /* Compare is exact to 64 bits. */
+    assert(Mult32x32AndCompare(0x7FFFFFFF, 0x7FFFFFFF, 0x7FFFFFFF, 0x7FFFFFFF) == 0) ;
+    assert(Mult32x32AndCompare(0x7FFFFFFF, 0x7FFFFFFE, 0x7FFFFFFF, 0x7FFFFFFF) == 1) ;
+    assert(Mult32x32AndCompare(-1, 1, 0, 0) == 1) ;
+    assert(Mult32x32AndCompare(0x10000, 0x8000, 0, 0) == -1) ;
+
+    /* Every pair and triple of edge values. */
+    for (i=0; i<NUM_EDGES; i++)  {
+        for (j=0; j<NUM_EDGES; j++)  {
+            ICheckShifts(G_edges[i], G_edges[j]) ;
+            for (k=0; k<NUM_EDGES; k++)  {
+                ICheckMultDiv(G_edges[i], G_edges[j], G_edges[k]) ;
+                ICheckCompare(G_edges[i], G_edges[j], G_edges[k], G_edges[j]) ;
+                ICheckCompare(G_edges[i], G_edges[j], G_edges[j], G_edges[k]) ;
+            }
+        }
+    }
+
+    /* And a lot of random values. */
+    for (i=0; i<1000000; i++)  {
+        a = IRandomValue() ;
+        b = IRandomValue() ;
+        c = IRandomValue() ;
+        d = IRandomValue() ;
+        ICheckShifts(a, b) ;
+        ICheckMultDiv(a, b, c) ;
+        ICheckCompare(a, b, c, d) ;
+    }
+
+    printf("All fixed point tests passed.\n");
+    return 0;
+}